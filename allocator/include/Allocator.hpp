@@ -3,11 +3,13 @@
 #include "MemoryPool.hpp"
 #include <cstdlib>
 #include <limits>
+#include <iterator>
 #include <memory>
 
 template <class _Ty>
 class Allocator {
-    static MemoryPool mem_pool;
+    // every instantiation shares MemoryPool::instance(), which is keyed by size and alignment only
+    static MemoryPool& mem_pool() { return MemoryPool::instance(); }
 public:
     using __Not_user_specialized = void;
     using value_type = _Ty;
@@ -26,13 +28,32 @@ public:
     pointer address(reference x) const noexcept { return static_cast<pointer>(&x); }
     const_pointer address(const_reference x) const noexcept { return static_cast<const_pointer>(&x); }
 
+    // hint: an object the new memory should be placed near, see MemoryPool::alloc
     pointer allocate(size_type n, const void* hint = 0) {
         if (n > max_size()) throw std::bad_array_new_length();
-        return static_cast<pointer>(mem_pool.alloc(n * sizeof(value_type)));
+#ifdef ALLOCATOR_STATS
+        MemoryPool::Stats& s = stats();
+        s.allocations++;
+        s.bytes_in_use += n * sizeof(value_type);
+        if (s.bytes_in_use > s.peak_bytes) s.peak_bytes = s.bytes_in_use;
+#endif
+        if (hint == nullptr) hint = MemoryPool::placement_hint();
+        return static_cast<pointer>(mem_pool().alloc(n * sizeof(value_type), alignof(value_type), hint));
     }
 
     void deallocate(pointer p, size_type n) {
-        mem_pool.free(p);
+#ifdef ALLOCATOR_STATS
+        MemoryPool::Stats& s = stats();
+        s.deallocations++;
+        s.bytes_in_use -= n * sizeof(value_type);
+#endif
+        mem_pool().free(p, n * sizeof(value_type), alignof(value_type));
+    }
+
+    // per-type tag for statistics; memory itself is shared across all types
+    static MemoryPool::Stats& stats() {
+        static MemoryPool::Stats s;
+        return s;
     }
 
     // https://en.cppreference.com/w/cpp/memory/allocator/destroy
@@ -49,9 +70,6 @@ public:
     }
 };
 
-template <class _Ty>
-MemoryPool Allocator<_Ty>::mem_pool;
-
 // https://en.cppreference.com/w/cpp/memory/allocator/operator_cmp
 template< class T1, class T2 >
 constexpr bool operator==(const Allocator<T1>& lhs, const Allocator<T2>& rhs) noexcept { return true; }
@@ -59,4 +77,14 @@ constexpr bool operator==(const Allocator<T1>& lhs, const Allocator<T2>& rhs) no
 template< class T1, class T2 >
 constexpr bool operator!=(const Allocator<T1>& lhs, const Allocator<T2>& rhs) noexcept { return false; }
 
-
+// Like tree.emplace_hint(pos, args...) for node-based containers using Allocator
+// (std::set, std::map, ...), but also asks the pool to place the new node in the
+// same chunk as its neighbour, so in-order traversal touches fewer cache lines and pages.
+template <class Tree, class... Args>
+typename Tree::iterator emplace_near(Tree& tree, typename Tree::const_iterator pos, Args&&... args) {
+    const void* neighbour = nullptr;
+    if (pos != tree.cend()) neighbour = std::addressof(*pos);
+    else if (!tree.empty()) neighbour = std::addressof(*std::prev(pos));
+    MemoryPool::PlacementHint guard(neighbour);
+    return tree.emplace_hint(pos, std::forward<Args>(args)...);
+}
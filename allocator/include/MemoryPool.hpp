@@ -1,48 +1,197 @@
 #pragma once
 #include <memory>
 #include <cstdlib>
+#include <cstddef>
+#include <new>
+#include <unordered_set>
+
+// Size-class memory pool shared by every Allocator<_Ty> instantiation.
+// Requests are keyed by (size, alignment) rather than by C++ type, so a block
+// released by Allocator<int> can be handed out again to Allocator<Point2D> or
+// to any rebound node type of the same size class.
 class MemoryPool {
-    static const size_t buffer_size = 0x1000; // 16 bytes
-    struct BufferBlock {
-        BufferBlock* next;
-        char data[1]; // Flexible array member
-    }*buffer_head;
+    static const size_t align_unit = alignof(std::max_align_t);      // 16 bytes
+    static const size_t max_small_size = 0x1000;                      // larger requests go to malloc directly
+    static const size_t class_count = max_small_size / align_unit;   // one class per align_unit step
+    static const size_t chunk_size = 0x10000;                         // 64 KiB carved into blocks of one class, aligned to its size
+    static const size_t page_size = 0x1000;
+    static const size_t hint_search = 16;                             // free blocks looked at for one in the hinted page
+
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    // every chunk starts with this header; since chunks are aligned to chunk_size,
+    // the chunk of any small block is found by masking its address
+    struct Chunk {
+        Chunk* next;                    // all chunks, for the destructor
+        Chunk* next_available;          // chunks of the same class that may have room left
+        FreeBlock* free_list = nullptr; // blocks returned by free()
+        char* bump;                     // unused tail of this chunk
+        size_t block_size;
+        bool available = true;          // whether this chunk is linked in its class's available list
+    };
+
+    struct SizeClass {
+        Chunk* available = nullptr;     // head is the chunk new blocks are taken from
+    } classes[class_count];
+
+    Chunk* chunks = nullptr;
+    std::unordered_set<const Chunk*> chunk_set; // to tell whether a hint points into this pool
+
+    static size_t class_index(size_t size) { return (size - 1) / align_unit; }
+    static size_t header_size() { return (sizeof(Chunk) + align_unit - 1) / align_unit * align_unit; }
+    static Chunk* chunk_of(const void* p) { return reinterpret_cast<Chunk*>((size_t)p & ~(chunk_size - 1)); }
+
+    static bool has_room(const Chunk* chunk) {
+        return chunk->free_list != nullptr || chunk->bump + chunk->block_size <= reinterpret_cast<const char*>(chunk) + chunk_size;
+    }
+
+    static void* take(Chunk* chunk) {
+        if (chunk->free_list) {
+            FreeBlock* block = chunk->free_list;
+            chunk->free_list = block->next;
+            return block;
+        }
+        void* p = chunk->bump;
+        chunk->bump += chunk->block_size;
+        return p;
+    }
+
+    // a block of chunk in the same page as hint: the next bump block, or one among the first few
+    // free blocks. otherwise any block of chunk.
+    static void* take_near(Chunk* chunk, const void* hint) {
+        char* end = reinterpret_cast<char*>(chunk) + chunk_size;
+        if (chunk->bump + chunk->block_size <= end && (size_t)chunk->bump / page_size == (size_t)hint / page_size) {
+            void* p = chunk->bump;
+            chunk->bump += chunk->block_size;
+            return p;
+        }
+        FreeBlock** link = &chunk->free_list;
+        for (size_t i = 0; *link != nullptr && i < hint_search; i++, link = &(*link)->next) {
+            if ((size_t)*link / page_size == (size_t)hint / page_size) {
+                FreeBlock* block = *link;
+                *link = block->next;
+                return block;
+            }
+        }
+        return take(chunk);
+    }
+
+    Chunk* new_chunk(SizeClass& sc, size_t block_size) {
+        void* memory = std::aligned_alloc(chunk_size, chunk_size);
+        if (!memory) throw std::bad_alloc();
+        Chunk* chunk = new (memory) Chunk();
+        chunk->next = chunks;
+        chunks = chunk;
+        chunk->next_available = sc.available;
+        sc.available = chunk;
+        chunk->bump = reinterpret_cast<char*>(chunk) + header_size();
+        chunk->block_size = block_size;
+        chunk_set.insert(chunk);
+        return chunk;
+    }
+
+    // the chunk of hint, if hint points into a chunk of the given block size that still has room
+    Chunk* hinted_chunk(const void* hint, size_t block_size) const {
+        if (hint == nullptr) return nullptr;
+        Chunk* chunk = chunk_of(hint);
+        if (chunk_set.find(chunk) == chunk_set.end()) return nullptr;
+        if (chunk->block_size != block_size || !has_room(chunk)) return nullptr;
+        return chunk;
+    }
 
 public:
-    MemoryPool() : buffer_head(nullptr) {}
+    // Per-type counters, only updated when ALLOCATOR_STATS is defined.
+    struct Stats {
+        size_t allocations = 0;
+        size_t deallocations = 0;
+        size_t bytes_in_use = 0;
+        size_t peak_bytes = 0;
+    };
+
+    MemoryPool() {}
 
     ~MemoryPool() {
-        BufferBlock* current = buffer_head;
+        Chunk* current = chunks;
         while (current) {
-            BufferBlock* next = current->next;
+            Chunk* next = current->next;
             std::free(current);
             current = next;
         }
     }
 
-    void* alloc(size_t size) {
-        size_t buffer_count = (size - 1) / buffer_size + 1;
-        size_t total_size = sizeof(BufferBlock) + (buffer_count * buffer_size) - 1;
-        BufferBlock* new_block = static_cast<BufferBlock*>(std::malloc(total_size));
-        if (!new_block) throw std::bad_alloc();
-        new_block->next = buffer_head;
-        buffer_head = new_block;
-        return static_cast<void*>(new_block->data);
+    MemoryPool(const MemoryPool&) = delete;
+    MemoryPool& operator=(const MemoryPool&) = delete;
+
+    // The pool behind every Allocator<_Ty>, built like the one in mem_Allocator.cpp (see there for why).
+    static MemoryPool& instance() {
+        alignas(MemoryPool) static unsigned char storage[sizeof(MemoryPool)];
+        static MemoryPool* pool = new (storage) MemoryPool();
+        return *pool;
     }
 
-    void free(void* p) {
-        BufferBlock* block = reinterpret_cast<BufferBlock*>(reinterpret_cast<char*>(p) - offsetof(BufferBlock, data));
-        if (buffer_head == block) {
-            buffer_head = buffer_head->next;
-        } else {
-            BufferBlock* current = buffer_head;
-            while (current && current->next != block) {
-                current = current->next;
-            }
-            if (current) {
-                current->next = block->next;
-            }
+    // Hint used by Allocator::allocate when the caller passes none, e.g. for
+    // the node std::map allocates inside emplace_hint (see emplace_near).
+    static const void*& placement_hint() {
+        static thread_local const void* hint = nullptr;
+        return hint;
+    }
+
+    // Sets placement_hint() for the current scope.
+    class PlacementHint {
+        const void* saved;
+    public:
+        explicit PlacementHint(const void* hint) : saved(placement_hint()) { placement_hint() = hint; }
+        ~PlacementHint() { placement_hint() = saved; }
+        PlacementHint(const PlacementHint&) = delete;
+        PlacementHint& operator=(const PlacementHint&) = delete;
+    };
+
+    // hint may point to any object; if it was allocated from a chunk of the same
+    // size class that still has room, the new block is placed in that chunk,
+    // preferably in the same page.
+    void* alloc(size_t size, size_t align = align_unit, const void* hint = nullptr) {
+        if (size == 0) size = 1;
+        if (align > align_unit) return ::operator new(size, std::align_val_t(align));
+        if (size > max_small_size) {
+            void* p = std::malloc(size);
+            if (!p) throw std::bad_alloc();
+            return p;
+        }
+        SizeClass& sc = classes[class_index(size)];
+        size_t block_size = (class_index(size) + 1) * align_unit;
+        if (Chunk* chunk = hinted_chunk(hint, block_size)) return take_near(chunk, hint);
+        // chunks filled up through hints are only dropped from the available list here
+        while (sc.available && !has_room(sc.available)) {
+            sc.available->available = false;
+            sc.available = sc.available->next_available;
+        }
+        Chunk* chunk = sc.available ? sc.available : new_chunk(sc, block_size);
+        return take(chunk);
+    }
+
+    // size and align must match the values passed to alloc().
+    void free(void* p, size_t size, size_t align = align_unit) {
+        if (p == nullptr) return;
+        if (size == 0) size = 1;
+        if (align > align_unit) {
+            ::operator delete(p, std::align_val_t(align));
+            return;
+        }
+        if (size > max_small_size) {
+            std::free(p);
+            return;
+        }
+        Chunk* chunk = chunk_of(p);
+        FreeBlock* block = static_cast<FreeBlock*>(p);
+        block->next = chunk->free_list;
+        chunk->free_list = block;
+        if (!chunk->available) {
+            SizeClass& sc = classes[class_index(size)];
+            chunk->available = true;
+            chunk->next_available = sc.available;
+            sc.available = chunk;
         }
-        std::free(block);
     }
-};
\ No newline at end of file
+};
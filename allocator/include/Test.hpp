@@ -50,6 +50,23 @@ std::tuple<bool, char, int, double> generateValue<std::tuple<bool, char, int, do
         std::make_tuple(static_cast<bool>(dist_bool(rng)), static_cast<char>(dist_char(rng)), rng(), dist_double(rng));
 }
 
+// overload the operator<< for std::pair and std::tuple
+template<typename X, typename Y>
+std::ostream& operator<<(std::ostream& os, const std::pair<X, Y>& pair) {
+    os << "(" << pair.first << ", " << pair.second << ")";
+    return os;
+}
+
+template<typename X, typename Y, typename Z, typename W>
+std::ostream& operator<<(std::ostream& os, const std::tuple<X, Y, Z, W>& tuple) {
+    os << "("
+        << std::get<0>(tuple) << ", "
+        << std::get<1>(tuple) << ", "
+        << std::get<2>(tuple) << ", "
+        << std::get<3>(tuple) << ")";
+    return os;
+}
+
 // linear container compare
 template <typename ContainerA, typename ContainerB>
 void compare(const ContainerA& a, const ContainerB& b) {
@@ -118,21 +135,4 @@ void compare_all(const ContainerA& a, const ContainerB& b) {
     }
 }
 
-// overload the operator<< for std::pair and std::tuple
-template<typename X, typename Y>
-std::ostream& operator<<(std::ostream& os, const std::pair<X, Y>& pair) {
-    os << "(" << pair.first << ", " << pair.second << ")";
-    return os;
-}
-
-template<typename X, typename Y, typename Z, typename W>
-std::ostream& operator<<(std::ostream& os, const std::tuple<X, Y, Z, W>& tuple) {
-    os << "("
-        << std::get<0>(tuple) << ", "
-        << std::get<1>(tuple) << ", "
-        << std::get<2>(tuple) << ", "
-        << std::get<3>(tuple) << ")";
-    return os;
-}
-
 #endif
\ No newline at end of file
@@ -0,0 +1,12 @@
+#include "mem_Allocator.hpp"
+
+#include <new>
+
+MemoryPool& MemoryPool::instance() {
+    // constructed in static storage on first use (thread-safe, no static-init-order dependency)
+    // and intentionally never destroyed: containers with static storage duration may still
+    // release memory after main() returns, and the OS reclaims everything at process exit.
+    alignas(MemoryPool) static unsigned char storage[sizeof(MemoryPool)];
+    static MemoryPool* pool = new (storage) MemoryPool();
+    return *pool;
+}
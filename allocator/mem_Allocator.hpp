@@ -1,15 +1,38 @@
 #pragma once
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdlib>
 #include <cstring>
 #include <limits>
 #include <memory>
+#include <type_traits>
+#include <unordered_map>
 #include <utility>
+#include <vector>
+#include <sys/mman.h>
+#include <unistd.h>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 class MemoryPool {
 public:
     static const size_t buffer_size = 131072;
+    static const size_t nontemporal_threshold = 65536; // zero larger regions with streaming stores that bypass the cache
+    static const size_t align_unit = alignof(std::max_align_t); // every allocation is rounded up to this, so the next one stays aligned
+
+    // expected lifetime of an allocation. each lifetime gets its own buffers, so a few long-lived
+    // allocations do not keep a buffer full of freed short-lived ones from being reused.
+    enum class Lifetime { Short, Long };
+
+    struct Stats {
+        size_t buffers_created = 0;   // buffers mapped from the system
+        size_t buffers_reclaimed = 0; // times a buffer became completely free and reusable from its start
+        size_t mapped_bytes = 0;      // address space currently mapped from the system (buffers and big blocks),
+                                      // pages handed back by purge() stay mapped and are still counted
+        size_t peak_mapped_bytes = 0;
+    };
 
 private:
     struct Buffer {           // store several small memory blocks
@@ -17,6 +40,10 @@ private:
         void* start = nullptr;  // record the starting address of the this buffer
         void* endp = nullptr;   // record the address of the unallocated memory of the this buffer
         size_t count = 0;       // record how many small memory blocks having not been released from this buffer
+        size_t live = 0;        // record how many bytes of this buffer are still in use
+        void* dirty = nullptr;  // record the end of the memory that may have been written since the buffer was mapped or purged
+        bool draining = false;  // set during compact() so that no new memory is placed in this buffer
+        Lifetime lifetime = Lifetime::Short; // only allocations of this lifetime are placed in this buffer
     } *buffers;
 
     struct Block {           // store big memory blocks that larger than buffer_size
@@ -25,46 +52,68 @@ private:
         bool is_freed = false; // record whether this block having been released from the memory
     } *blocks;
 
-    void free_buffer(Buffer* it) {
-        if (it == nullptr) return;
-        std::free(it->start);
-        free_buffer(it->next);
-        delete it;
-    }
+    struct Relocatable {       // a registered allocation that compact() is allowed to move
+        size_t size;
+        void* owner;           // the handle that refers to this allocation
+        void (*relocate)(void* owner, void* new_pointer); // updates the handle after the memory has been moved
+    };
+    std::unordered_map<void*, Relocatable> relocatables;
 
-    void free_block(Block* it) {
-        if (it == nullptr) return;
-        if (!it->is_freed) { std::free(it->start); }
-        free_block(it->next);
-        delete it;
+    Stats statistics;
+
+    void add_mapped(size_t size) {
+        statistics.mapped_bytes += size;
+        statistics.peak_mapped_bytes = std::max(statistics.peak_mapped_bytes, statistics.mapped_bytes);
     }
 
-public:
-    MemoryPool() {
-        buffers = nullptr;
-        blocks = nullptr;
+    // buffers are mapped straight from the OS, so their pages are known to be zero until handed out
+    static void* map_buffer() {
+        void* start = mmap(nullptr, buffer_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (start == MAP_FAILED) throw std::bad_alloc();
+        return start;
     }
 
-    ~MemoryPool() {
-        free_buffer(buffers);
-        free_block(blocks);
+    static void unmap_buffer(void* start) {
+        munmap(start, buffer_size);
     }
 
-    // disable copy constructor and others to avoid the memory pool from being copied.
-    MemoryPool(MemoryPool&& memoryPool) = delete;
-    MemoryPool(const MemoryPool& memoryPool) = delete;
-    MemoryPool operator=(MemoryPool&& memoryPool) = delete;
-    MemoryPool operator=(const MemoryPool& memoryPool) = delete;
+    static void zero_memory(void* pointer, size_t size) {
+#if defined(__SSE2__)
+        if (size >= nontemporal_threshold) {
+            // a region this large would only evict useful cache lines, so stream the zeros to memory
+            char* p = static_cast<char*>(pointer);
+            char* end = p + size;
+            while (((size_t)p & 15) != 0) *p++ = 0;
+            __m128i zero = _mm_setzero_si128();
+            for (; p + 64 <= end; p += 64) {
+                _mm_stream_si128(reinterpret_cast<__m128i*>(p), zero);
+                _mm_stream_si128(reinterpret_cast<__m128i*>(p + 16), zero);
+                _mm_stream_si128(reinterpret_cast<__m128i*>(p + 32), zero);
+                _mm_stream_si128(reinterpret_cast<__m128i*>(p + 48), zero);
+            }
+            _mm_sfence();
+            memset(p, 0, end - p);
+            return;
+        }
+#endif
+        memset(pointer, 0, size);
+    }
 
-    void* malloc(size_t size) {
+    // dirty receives how many leading bytes of the result may hold old data, the rest is known to be zero.
+    // zeroed asks for big blocks to come from calloc, which gets fresh pages without clearing them again.
+    void* allocate(size_t size, bool zeroed, size_t& dirty, Lifetime lifetime) {
+        size = aligned_size(size);
         if (size <= buffer_size) {
             // if the size of the requested memory is less than the buffer_size limit, try to allocate from the buffer pool
             for (Buffer* it = buffers; it != nullptr; it = it->next) {
-                if ((size_t)(it->endp) + size <= (size_t)(it->start) + buffer_size) {
+                if (it->lifetime == lifetime && !it->draining && (size_t)(it->endp) + size <= (size_t)(it->start) + buffer_size) {
                     // found an existing buffer that can allocate the current memory
                     void* result = it->endp;
                     it->count++;
+                    it->live += size;
                     it->endp = (void*)((size_t)(it->endp) + size);
+                    dirty = it->dirty > result ? std::min(size, (size_t)(it->dirty) - (size_t)(result)) : 0;
+                    if (it->endp > it->dirty) it->dirty = it->endp;
                     return result;
                 }
             }
@@ -72,53 +121,231 @@ public:
             Buffer* it = new Buffer();
             it->next = buffers;
             buffers = it;
-            it->start = std::malloc(buffer_size);
+            it->start = map_buffer();
+            it->lifetime = lifetime;
+            statistics.buffers_created++;
+            add_mapped(buffer_size);
             it->endp = (void*)((size_t)(it->start) + size);
+            it->dirty = it->endp;
             it->count = 1;
+            it->live = size;
+            dirty = 0;
             return it->start;
         } else {
             // if the size of the requested memory is greater than the buffer_size limit, a whole block of memory is directly requested (no optimization)
+            dirty = zeroed ? 0 : size;
+            add_mapped(size);
             for (Block* it = blocks; it != nullptr; it = it->next) {
                 if (it->is_freed) {
                     // found an empty node in the list, so that the length of the linked list can be saved
                     it->is_freed = false;
-                    return it->start = std::malloc(size);
+                    return it->start = zeroed ? std::calloc(1, size) : std::malloc(size);
                 }
             }
             // append a new node to the linked list
             Block* it = new Block();
             it->next = blocks;
             blocks = it;
-            return it->start = std::malloc(size);
+            return it->start = zeroed ? std::calloc(1, size) : std::malloc(size);
         }
     }
 
-    void* cmalloc(size_t size) {
-        void* pointer = malloc(size);
-        memset(pointer, 0, size);
+    static size_t aligned_size(size_t size) {
+        return (size + align_unit - 1) / align_unit * align_unit;
+    }
+
+    void free_buffer(Buffer* it) {
+        if (it == nullptr) return;
+        unmap_buffer(it->start);
+        free_buffer(it->next);
+        delete it;
+    }
+
+    void free_block(Block* it) {
+        if (it == nullptr) return;
+        if (!it->is_freed) { std::free(it->start); }
+        free_block(it->next);
+        delete it;
+    }
+
+public:
+    MemoryPool() {
+        buffers = nullptr;
+        blocks = nullptr;
+    }
+
+    ~MemoryPool() {
+        free_buffer(buffers);
+        free_block(blocks);
+    }
+
+    // the single process-wide pool shared by every translation unit, see mem_Allocator.cpp.
+    static MemoryPool& instance();
+
+    // disable copy constructor and others to avoid the memory pool from being copied.
+    MemoryPool(MemoryPool&& memoryPool) = delete;
+    MemoryPool(const MemoryPool& memoryPool) = delete;
+    MemoryPool operator=(MemoryPool&& memoryPool) = delete;
+    MemoryPool operator=(const MemoryPool& memoryPool) = delete;
+
+    void* malloc(size_t size, Lifetime lifetime = Lifetime::Short) {
+        size_t dirty;
+        return allocate(size, false, dirty, lifetime);
+    }
+
+    // only the part of the result that may have been used before is cleared, fresh pages are already zero
+    void* cmalloc(size_t size, Lifetime lifetime = Lifetime::Short) {
+        size_t dirty;
+        void* pointer = allocate(size, true, dirty, lifetime);
+        if (dirty > 0) zero_memory(pointer, dirty);
         return pointer;
     }
 
-    void free(void* pointer) {
+    // size must be the size passed to malloc(), it is used to keep track of how densely each buffer is occupied
+    void free(void* pointer, size_t size) {
+        size = aligned_size(size);
         for (Buffer* it = buffers; it != nullptr; it = it->next) {
             if (it->start <= pointer && pointer < (void*)((size_t)(it->start) + buffer_size)) { // 当前内存起始位置在buffer的内存区间中
                 it->count--;
+                it->live -= size;
                 if (it->count == 0) {
                     it->endp = it->start;
+                    statistics.buffers_reclaimed++;
                     // if the memory in the current buffer has been completely released, the buffer can be reused from the beginning
                 }
+                return;
             }
         }
         for (Block* it = blocks; it != nullptr; it = it->next) {
             if (it->start == pointer) {
                 ::free(it->start);
                 it->is_freed = true;
+                statistics.mapped_bytes -= size;
                 return;
             }
         }
     }
+
+    // ---- opt-in compaction ----
+    // A buffer can only be reused once every allocation in it is freed, so a few survivors pin a whole buffer.
+    // Allocations registered as relocatable can be moved out of sparsely occupied buffers by compact(),
+    // after which release_empty() gives the emptied buffers back to the system.
+
+    struct BufferInfo {
+        const void* start;
+        size_t count;     // allocations still alive in this buffer
+        size_t live;      // bytes still in use
+        size_t used;      // bytes handed out since the buffer was last reset
+        Lifetime lifetime;
+    };
+
+    // occupancy of every buffer, for deciding whether a compaction is worth it
+    std::vector<BufferInfo> buffer_report() const {
+        std::vector<BufferInfo> report;
+        for (Buffer* it = buffers; it != nullptr; it = it->next) {
+            report.push_back({ it->start, it->count, it->live, (size_t)(it->endp) - (size_t)(it->start), it->lifetime });
+        }
+        return report;
+    }
+
+    // buffers that are in use but hold no more than max_occupancy * buffer_size live bytes
+    size_t sparse_buffer_count(double max_occupancy = 0.25) const {
+        size_t n = 0;
+        for (Buffer* it = buffers; it != nullptr; it = it->next) {
+            if (it->count > 0 && it->live <= max_occupancy * buffer_size) n++;
+        }
+        return n;
+    }
+
+    // pointer must be returned by malloc(size); compact() may move it and then calls relocate(owner, new_pointer).
+    // the contents are moved with memcpy, so only trivially relocatable data may be registered.
+    void register_relocatable(void* pointer, size_t size, void* owner, void (*relocate)(void*, void*)) {
+        relocatables[pointer] = { size, owner, relocate };
+    }
+
+    void unregister_relocatable(void* pointer) {
+        relocatables.erase(pointer);
+    }
+
+    // moves registered allocations out of sparse buffers into dense ones and releases the buffers that became empty.
+    // returns the number of bytes moved. any raw pointer into moved memory is invalidated.
+    size_t compact(double max_occupancy = 0.25) {
+        for (Buffer* it = buffers; it != nullptr; it = it->next) {
+            it->draining = it->count > 0 && it->live <= max_occupancy * buffer_size;
+        }
+        std::vector<std::pair<void*, Relocatable>> moving;
+        std::vector<Lifetime> lifetimes;
+        for (auto& entry : relocatables) {
+            Buffer* owner_buffer = find_buffer(entry.first);
+            if (owner_buffer != nullptr && owner_buffer->draining) {
+                moving.push_back(entry);
+                lifetimes.push_back(owner_buffer->lifetime);
+            }
+        }
+        size_t moved = 0;
+        for (size_t i = 0; i < moving.size(); i++) {
+            void* old_pointer = moving[i].first;
+            Relocatable reloc = moving[i].second;
+            void* new_pointer = malloc(reloc.size, lifetimes[i]);
+            std::memcpy(new_pointer, old_pointer, reloc.size);
+            reloc.relocate(reloc.owner, new_pointer);
+            relocatables.erase(old_pointer);
+            relocatables[new_pointer] = reloc;
+            free(old_pointer, reloc.size);
+            moved += reloc.size;
+        }
+        for (Buffer* it = buffers; it != nullptr; it = it->next) {
+            it->draining = false;
+        }
+        release_empty();
+        return moved;
+    }
+
+    // gives buffers without any live allocation back to the system, returns the number of buffers released
+    size_t release_empty() {
+        size_t released = 0;
+        Buffer** link = &buffers;
+        while (*link != nullptr) {
+            Buffer* it = *link;
+            if (it->count == 0) {
+                *link = it->next;
+                unmap_buffer(it->start);
+                delete it;
+                released++;
+                statistics.mapped_bytes -= buffer_size;
+            } else {
+                link = &it->next;
+            }
+        }
+        return released;
+    }
+
+    // gives the unused pages of every buffer back to the system with MADV_DONTNEED. they read as zero afterwards,
+    // so later cmalloc() calls need not clear them. returns the number of bytes purged.
+    size_t purge() {
+        const size_t page_size = sysconf(_SC_PAGESIZE);
+        size_t purged = 0;
+        for (Buffer* it = buffers; it != nullptr; it = it->next) {
+            size_t from = ((size_t)(it->endp) + page_size - 1) / page_size * page_size;
+            size_t to = ((size_t)(it->dirty) + page_size - 1) / page_size * page_size;
+            if (from >= to) continue;
+            madvise((void*)from, to - from, MADV_DONTNEED);
+            it->dirty = (void*)from; // the partial page right after endp is kept and may still be dirty
+            purged += to - from;
+        }
+        return purged;
+    }
+
+    const Stats& stats() const { return statistics; }
+
+private:
+    Buffer* find_buffer(const void* pointer) const {
+        for (Buffer* it = buffers; it != nullptr; it = it->next) {
+            if (it->start <= pointer && pointer < (void*)((size_t)(it->start) + buffer_size)) return it;
+        }
+        return nullptr;
+    }
 };
-static MemoryPool _pool;
 
 template <class _Ty>
 class Allocator {
@@ -148,11 +375,11 @@ public:
     }
 
     pointer allocate(size_type n) {
-        return static_cast<pointer>(_pool.malloc(n * sizeof(_Ty)));
+        return static_cast<pointer>(MemoryPool::instance().malloc(n * sizeof(_Ty)));
     }
 
     void deallocate(pointer p, size_type n) {
-        _pool.free(p);
+        MemoryPool::instance().free(p, n * sizeof(_Ty));
     }
 
     size_type max_size() const {
@@ -177,3 +404,261 @@ bool operator==(const Allocator<_Ty>&, const Allocator<_Ty>&) { return true; }
 template <class _Ty>
 bool operator!=(const Allocator<_Ty>&, const Allocator<_Ty>&) { return false; }
 
+// A vector of scalars whose new elements are zero, e.g. resize() of a large int vector. Its storage
+// comes from cmalloc(), and zero_end_ marks how far that storage may have been written since: growing
+// above the mark costs nothing, growing back into slots given up by resize(), pop_back(), erase() or
+// clear() clears just those slots. Destroying elements writes nothing.
+template <class _Ty>
+class ZeroVector {
+    static_assert(std::is_scalar<_Ty>::value && !std::is_member_pointer<_Ty>::value,
+        "ZeroVector requires an element type whose value-initialised form is all zero bytes");
+
+    _Ty* data_ = nullptr;
+    size_t size_ = 0;
+    size_t capacity_ = 0;
+    size_t zero_end_ = 0; // slots from zero_end_ to capacity_ are still zero
+
+    void reallocate(size_t new_capacity) {
+        _Ty* new_data = nullptr;
+        if (new_capacity > 0) {
+            new_data = static_cast<_Ty*>(MemoryPool::instance().cmalloc(new_capacity * sizeof(_Ty)));
+            if (size_ > 0) std::memcpy(new_data, data_, size_ * sizeof(_Ty));
+        }
+        release();
+        data_ = new_data;
+        capacity_ = new_capacity;
+        zero_end_ = size_;
+    }
+
+    void release() {
+        if (data_ == nullptr) return;
+        MemoryPool::instance().free(data_, capacity_ * sizeof(_Ty));
+        data_ = nullptr;
+    }
+
+public:
+    using value_type = _Ty;
+    using size_type = size_t;
+    using iterator = _Ty*;
+    using const_iterator = const _Ty*;
+
+    ZeroVector() = default;
+    explicit ZeroVector(size_type n) { resize(n); }
+
+    ZeroVector(const ZeroVector& other) {
+        reserve(other.size_);
+        if (other.size_ > 0) std::memcpy(data_, other.data_, other.size_ * sizeof(_Ty));
+        size_ = zero_end_ = other.size_;
+    }
+
+    ZeroVector(ZeroVector&& other) noexcept {
+        swap(other);
+    }
+
+    ZeroVector& operator=(ZeroVector other) noexcept {
+        swap(other);
+        return *this;
+    }
+
+    ~ZeroVector() { release(); }
+
+    void swap(ZeroVector& other) noexcept {
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+        std::swap(capacity_, other.capacity_);
+        std::swap(zero_end_, other.zero_end_);
+    }
+
+    size_type size() const { return size_; }
+    size_type capacity() const { return capacity_; }
+    bool empty() const { return size_ == 0; }
+
+    _Ty* data() { return data_; }
+    const _Ty* data() const { return data_; }
+    iterator begin() { return data_; }
+    iterator end() { return data_ + size_; }
+    const_iterator begin() const { return data_; }
+    const_iterator end() const { return data_ + size_; }
+
+    _Ty& operator[](size_type i) { return data_[i]; }
+    const _Ty& operator[](size_type i) const { return data_[i]; }
+
+    void reserve(size_type n) {
+        if (n > capacity_) reallocate(n);
+    }
+
+    void resize(size_type n) {
+        if (n > capacity_) reallocate(std::max(n, capacity_ * 2));
+        else if (n > size_ && size_ < zero_end_) std::memset(data_ + size_, 0, (std::min(n, zero_end_) - size_) * sizeof(_Ty));
+        size_ = n;
+        zero_end_ = std::max(zero_end_, size_);
+    }
+
+    void push_back(const _Ty& value) {
+        _Ty copy = value; // value may live in the storage being reallocated
+        if (size_ == capacity_) reallocate(capacity_ == 0 ? 1 : capacity_ * 2);
+        data_[size_++] = copy;
+        zero_end_ = std::max(zero_end_, size_);
+    }
+
+    void pop_back() { size_--; }
+    void clear() { size_ = 0; }
+
+    iterator erase(const_iterator pos) {
+        return erase(pos, pos + 1);
+    }
+
+    iterator erase(const_iterator first, const_iterator last) {
+        _Ty* dest = data_ + (first - data_);
+        std::memmove(dest, last, (end() - last) * sizeof(_Ty));
+        size_ -= last - first;
+        return dest;
+    }
+
+    // gives the unused part of the storage back to the pool
+    void shrink_to_fit() {
+        if (size_ < capacity_) reallocate(size_);
+    }
+};
+
+// Allocator for containers that live much longer than the surrounding allocations, e.g. a map filled
+// during the whole run while temporary vectors come and go. Its memory is kept in separate buffers,
+// so it does not pin the buffers of short-lived allocations.
+template <class _Ty>
+class LongLivedAllocator : public Allocator<_Ty> {
+public:
+    using typename Allocator<_Ty>::pointer;
+    using typename Allocator<_Ty>::size_type;
+
+    template <typename U>
+    struct rebind {
+        typedef LongLivedAllocator<U> other;
+    };
+
+    LongLivedAllocator() = default;
+    template <class U>
+    LongLivedAllocator(const LongLivedAllocator<U>&) noexcept {}
+
+    pointer allocate(size_type n) {
+        return static_cast<pointer>(MemoryPool::instance().malloc(n * sizeof(_Ty), MemoryPool::Lifetime::Long));
+    }
+};
+
+// A vector for trivially relocatable element types whose storage is registered with the pool,
+// so MemoryPool::compact() may move it into a denser buffer. The vector itself is the handle:
+// always go through it, pointers and iterators into it are invalidated by compact().
+template <class _Ty>
+class CompactVector {
+    static_assert(std::is_trivially_copyable<_Ty>::value, "CompactVector requires a trivially relocatable element type");
+
+    _Ty* data_ = nullptr;
+    size_t size_ = 0;
+    size_t capacity_ = 0;
+
+    void reallocate(size_t new_capacity) {
+        MemoryPool& pool = MemoryPool::instance();
+        _Ty* new_data = nullptr;
+        if (new_capacity > 0) {
+            new_data = static_cast<_Ty*>(pool.malloc(new_capacity * sizeof(_Ty)));
+            if (size_ > 0) std::memcpy(new_data, data_, size_ * sizeof(_Ty));
+        }
+        release();
+        data_ = new_data;
+        capacity_ = new_capacity;
+        track();
+    }
+
+    static void relocate(void* owner, void* new_pointer) {
+        static_cast<CompactVector*>(owner)->data_ = static_cast<_Ty*>(new_pointer);
+    }
+
+    void track() {
+        if (data_ != nullptr) MemoryPool::instance().register_relocatable(data_, capacity_ * sizeof(_Ty), this, &relocate);
+    }
+
+    void release() {
+        if (data_ == nullptr) return;
+        MemoryPool& pool = MemoryPool::instance();
+        pool.unregister_relocatable(data_);
+        pool.free(data_, capacity_ * sizeof(_Ty));
+        data_ = nullptr;
+    }
+
+public:
+    using value_type = _Ty;
+    using size_type = size_t;
+
+    CompactVector() = default;
+    explicit CompactVector(size_type n) { resize(n); }
+
+    CompactVector(const CompactVector& other) {
+        reserve(other.size_);
+        if (other.size_ > 0) std::memcpy(data_, other.data_, other.size_ * sizeof(_Ty));
+        size_ = other.size_;
+    }
+
+    // the pool refers to the owning CompactVector, so moving has to re-register the storage
+    CompactVector(CompactVector&& other) noexcept {
+        swap(other);
+    }
+
+    CompactVector& operator=(CompactVector other) noexcept {
+        swap(other);
+        return *this;
+    }
+
+    ~CompactVector() { release(); }
+
+    void swap(CompactVector& other) noexcept {
+        MemoryPool& pool = MemoryPool::instance();
+        if (data_ != nullptr) pool.unregister_relocatable(data_);
+        if (other.data_ != nullptr) pool.unregister_relocatable(other.data_);
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+        std::swap(capacity_, other.capacity_);
+        track();
+        other.track();
+    }
+
+    size_type size() const { return size_; }
+    size_type capacity() const { return capacity_; }
+    bool empty() const { return size_ == 0; }
+
+    _Ty* data() { return data_; }
+    const _Ty* data() const { return data_; }
+    _Ty* begin() { return data_; }
+    _Ty* end() { return data_ + size_; }
+    const _Ty* begin() const { return data_; }
+    const _Ty* end() const { return data_ + size_; }
+
+    _Ty& operator[](size_type i) { return data_[i]; }
+    const _Ty& operator[](size_type i) const { return data_[i]; }
+
+    void reserve(size_type n) {
+        if (n > capacity_) reallocate(n);
+    }
+
+    void resize(size_type n) {
+        reserve(n);
+        for (size_type i = size_; i < n; i++) new (data_ + i) _Ty();
+        size_ = n;
+    }
+
+    void push_back(const _Ty& value) {
+        if (size_ == capacity_) {
+            _Ty copy = value; // value may live in the storage being reallocated
+            reallocate(capacity_ == 0 ? 1 : capacity_ * 2);
+            data_[size_++] = copy;
+            return;
+        }
+        data_[size_++] = value;
+    }
+
+    void pop_back() { size_--; }
+    void clear() { size_ = 0; }
+
+    // gives the storage back to the pool
+    void shrink_to_fit() {
+        if (size_ < capacity_) reallocate(size_);
+    }
+};
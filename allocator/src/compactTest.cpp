@@ -0,0 +1,50 @@
+#include "mem_Allocator.hpp"
+#include "Test.hpp"
+#include <bits/stdc++.h>
+
+// fill the pool with interleaved short-lived and relocatable vectors, free most of them,
+// then check that compact() moves the survivors and gives the sparse buffers back
+void compactTest() {
+    std::cout << "Running compaction test" << std::endl;
+    MemoryPool& pool = MemoryPool::instance();
+    std::vector<CompactVector<int>> kept;
+    std::vector<std::vector<int>> expected;
+    {
+        std::vector<std::vector<int, Allocator<int>>> temporary;
+        for (int i = 0; i < OPERATIONS / 50; i++) {
+            size_t size = rng() % 1000 + 1;
+            temporary.emplace_back(size, i);
+            CompactVector<int> v;
+            for (size_t j = 0; j < size; j++) v.push_back(generateValue<int>());
+            if (rng() % 10 == 0) {
+                expected.emplace_back(v.begin(), v.end());
+                kept.push_back(std::move(v));
+            }
+        }
+    }
+
+    pool.release_empty();
+    size_t buffers_before = pool.buffer_report().size();
+    size_t sparse_before = pool.sparse_buffer_count();
+    std::cerr << "buffers: " << buffers_before << ", sparse: " << sparse_before << std::endl;
+    assert(sparse_before > 0 && "Survivors should leave sparse buffers behind.");
+
+    size_t moved = pool.compact();
+    size_t buffers_after = pool.buffer_report().size();
+    std::cerr << "moved " << moved << " bytes, buffers: " << buffers_after << std::endl;
+    assert(moved > 0 && "Compaction should move relocatable storage.");
+    assert(buffers_after < buffers_before && "Compaction should release sparse buffers.");
+
+    assert(kept.size() == expected.size());
+    for (size_t i = 0; i < kept.size(); i++) {
+        compare(kept[i], expected[i]);
+    }
+    std::cout << "Compaction test passed." << std::endl;
+}
+
+int main() {
+    std::cout << "Running compact tests..." << std::endl;
+    compactTest();
+    std::cout << "All compact tests passed.\n" << std::endl;
+    return 0;
+}
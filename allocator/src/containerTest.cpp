@@ -1,4 +1,8 @@
+#ifdef USE_MEM_ALLOCATOR
+#include "mem_Allocator.hpp"
+#else
 #include "Allocator.hpp"
+#endif
 #include "Test.hpp"
 #include <bits/stdc++.h>
 
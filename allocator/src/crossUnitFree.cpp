@@ -0,0 +1,17 @@
+#include "mem_Allocator.hpp"
+#include <map>
+#include <vector>
+
+// second translation unit of crossUnitTest.cpp: frees what the first one allocated
+
+using IntVec = std::vector<int, Allocator<int>>;
+using IntMap = std::map<int, int, std::less<int>, Allocator<std::pair<const int, int>>>;
+
+void freeVectors(std::vector<IntVec*>& vectors) {
+    for (IntVec* v : vectors) delete v;
+    vectors.clear();
+}
+
+void freeMap(IntMap* map) {
+    delete map;
+}
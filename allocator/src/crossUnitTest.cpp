@@ -0,0 +1,62 @@
+#include "mem_Allocator.hpp"
+#include "Test.hpp"
+#include <bits/stdc++.h>
+
+// memory allocated in this translation unit is freed in crossUnitFree.cpp,
+// both have to reach the same MemoryPool::instance() from libmem_allocator.a
+
+using IntVec = std::vector<int, Allocator<int>>;
+using IntMap = std::map<int, int, std::less<int>, Allocator<std::pair<const int, int>>>;
+
+void freeVectors(std::vector<IntVec*>& vectors);
+void freeMap(IntMap* map);
+
+struct Occupancy {
+    size_t buffers = 0;
+    size_t count = 0;
+    size_t live = 0;
+    bool operator==(const Occupancy& other) const {
+        return buffers == other.buffers && count == other.count && live == other.live;
+    }
+};
+
+Occupancy occupancy() {
+    MemoryPool& pool = MemoryPool::instance();
+    pool.release_empty();
+    Occupancy result;
+    for (const MemoryPool::BufferInfo& info : pool.buffer_report()) {
+        result.buffers++;
+        result.count += info.count;
+        result.live += info.live;
+    }
+    return result;
+}
+
+void crossUnitTest() {
+    std::cout << "Running cross translation unit test" << std::endl;
+    Occupancy before = occupancy();
+
+    std::vector<IntVec*> vectors;
+    IntMap* map = new IntMap();
+    for (int i = 0; i < OPERATIONS / 100; i++) {
+        vectors.push_back(new IntVec(rng() % 1000 + 1, i));
+        map->emplace(generateValue<int>(), i);
+    }
+    Occupancy during = occupancy();
+    std::cerr << "buffers: " << before.buffers << " -> " << during.buffers << std::endl;
+    assert(during.count > before.count && during.live > before.live);
+
+    freeVectors(vectors);
+    freeMap(map);
+    Occupancy after = occupancy();
+    std::cerr << "buffers after free: " << after.buffers << std::endl;
+    assert(after == before && "Memory freed in another translation unit was not returned to the pool.");
+    std::cout << "Cross translation unit test passed." << std::endl;
+}
+
+int main() {
+    std::cout << "Running cross translation unit tests..." << std::endl;
+    crossUnitTest();
+    std::cout << "All cross translation unit tests passed.\n" << std::endl;
+    return 0;
+}
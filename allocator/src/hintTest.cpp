@@ -0,0 +1,152 @@
+#include "Allocator.hpp"
+#include "Test.hpp"
+#include <bits/stdc++.h>
+
+// chunks of MemoryPool are 64 KiB and aligned to their size
+bool sameChunk(const void* a, const void* b) {
+    return ((size_t)a >> 16) == ((size_t)b >> 16);
+}
+
+// set filled through emplace_near, with erases mixed in
+template <class T>
+void setTest(const char* type_name) {
+    std::cout << "Running emplace_near set test of " << type_name << std::endl;
+    MySet<T, Allocator<T>> a;
+    StdSet<T, std::allocator<T>> b;
+    for (int i = 0; i < OPERATIONS; i++) {
+        int op = rng() % 3;
+        switch (op) {
+        case 0:
+        {// clear
+            if (rng() % 64 == 0) { // to have less clear
+                std::cerr << "clear set" << std::endl;
+                a.clear();
+                b.clear();
+                break;
+            }
+        }
+        case 1:
+        {// erase
+            if (!a.empty()) {
+                T val_erase = generateValue<T>();
+                auto it = a.lower_bound(val_erase);
+                if (it == a.end()) it = a.begin();
+                std::cerr << "erase " << *it << std::endl;
+                b.erase(*it);
+                a.erase(it);
+            }
+        }
+        case 2:
+        {// insert next to its neighbour
+            T val_insert = generateValue<T>();
+            std::cerr << "insert " << val_insert << std::endl;
+            emplace_near(a, a.lower_bound(val_insert), val_insert);
+            b.insert(val_insert);
+            break;
+        }
+        default:
+            break;
+        }
+
+        compare(a, b);
+    }
+    std::cout << "Set test passed." << std::endl;
+}
+
+// map filled through emplace_near, with erases mixed in
+template <class Key, class T>
+void mapTest(const char* type_name) {
+    std::cout << "Running emplace_near map test of " << type_name << std::endl;
+    MyMap<Key, T, Allocator<std::pair<const Key, T>>> a;
+    StdMap<Key, T, std::allocator<std::pair<const Key, T>>> b;
+    for (int i = 0; i < OPERATIONS; i++) {
+        int op = rng() % 3;
+        switch (op) {
+        case 0:
+        {// clear
+            if (rng() % 64 == 0) { // to have less clear
+                a.clear();
+                b.clear();
+                std::cerr << "clear map" << std::endl;
+                break;
+            }
+        }
+        case 1:
+        {// erase
+            if (!a.empty()) {
+                auto it_a = a.begin();
+                std::advance(it_a, rng() % std::min<size_t>(a.size(), 64));
+                std::cerr << "erase (" << it_a->first << " " << it_a->second << ")" << std::endl;
+                b.erase(it_a->first);
+                a.erase(it_a);
+            }
+        }
+        case 2:
+        {// insert next to its neighbour
+            Key key = generateValue<Key>();
+            T value = generateValue<T>();
+            std::cerr << "insert (" << key << " " << value << ")" << std::endl;
+            auto pos = a.lower_bound(key);
+            if (pos == a.end() || pos->first != key) emplace_near(a, pos, key, value);
+            b.emplace(key, value);
+            break;
+        }
+        default:
+            break;
+        }
+
+        compare_map(a, b);
+    }
+    std::cout << "Map test passed." << std::endl;
+}
+
+// hints that cannot be honoured must be ignored
+void foreignHintTest() {
+    std::cout << "Running foreign hint test" << std::endl;
+    using Block48 = std::array<char, 48>;
+    using Block16 = std::array<char, 16>;
+    Allocator<Block48> alloc48;
+    Allocator<Block16> alloc16;
+
+    // a hint into a chunk of the same size class places the block in that chunk
+    Block48* base = alloc48.allocate(1);
+    Block48* near = alloc48.allocate(1, base);
+    assert(sameChunk(base, near) && "Hint into the same size class was not honoured.");
+
+    // hints outside the pool
+    int on_stack = 0;
+    void* from_malloc = std::malloc(64);
+    std::vector<char, Allocator<char>> big(0x2000); // more than 4 KiB: served by malloc, not by a chunk
+    const void* outside[] = { &on_stack, from_malloc, big.data(), &rng };
+    std::vector<Block16*> blocks;
+    for (const void* hint : outside) {
+        Block16* p = alloc16.allocate(1, hint);
+        (*p)[0] = 1;
+        blocks.push_back(p);
+    }
+
+    // a hint into a chunk of another size class
+    for (int i = 0; i < 16; i++) {
+        Block16* p = alloc16.allocate(1, base);
+        assert(!sameChunk(p, base) && "Block was placed in a chunk of another size class.");
+        (*p)[0] = 1;
+        blocks.push_back(p);
+    }
+
+    std::set<Block16*> distinct(blocks.begin(), blocks.end());
+    assert(distinct.size() == blocks.size() && "Same block handed out twice.");
+    for (Block16* p : blocks) alloc16.deallocate(p, 1);
+    alloc48.deallocate(near, 1);
+    alloc48.deallocate(base, 1);
+    std::free(from_malloc);
+    std::cout << "Foreign hint test passed." << std::endl;
+}
+
+int main() {
+    std::cout << "Running hint tests..." << std::endl;
+    setTest<int>("int");
+    mapTest<int, int>("map<const int, int>");
+    foreignHintTest();
+    std::cout << "All hint tests passed.\n" << std::endl;
+    return 0;
+}
@@ -0,0 +1,44 @@
+#include "mem_Allocator.hpp"
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <map>
+#include <random>
+#include <sys/resource.h>
+
+// Short-lived vectors come and go while a long-lived map keeps growing, as in
+// containerTest's interleaved vector/set/map operations. With "mixed" the map
+// uses Allocator and its nodes end up in the same buffers as the vectors; with
+// "tagged" it uses LongLivedAllocator. Usage: lifetimeBench [mixed|tagged]
+
+const int Operations = 100000;
+const size_t Window = 64; // short-lived vectors alive at the same time
+
+std::mt19937 rng(67656);
+
+template <class LongAlloc>
+void run(const char* name) {
+    std::map<int, int, std::less<int>, LongAlloc> kept;
+    std::deque<std::vector<int, Allocator<int>>> recent;
+    for (int i = 0; i < Operations; i++) {
+        recent.emplace_back(rng() % 500 + 1);
+        if (recent.size() > Window) recent.pop_front();
+        if (i % 8 == 0) kept.emplace(static_cast<int>(rng()), i);
+    }
+
+    const MemoryPool::Stats& stats = MemoryPool::instance().stats();
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    std::cout << name << ": "
+        << stats.buffers_created << " buffers created, "
+        << stats.buffers_reclaimed << " reclaimed ("
+        << 100.0 * stats.buffers_reclaimed / (stats.buffers_reclaimed + stats.buffers_created) << "% of buffer fills), "
+        << "peak mapped " << stats.peak_mapped_bytes / 1024 << " KiB, "
+        << "max RSS " << usage.ru_maxrss << " KiB" << std::endl;
+}
+
+int main(int argc, char** argv) {
+    if (argc > 1 && std::strcmp(argv[1], "tagged") == 0) run<LongLivedAllocator<std::pair<const int, int>>>("tagged");
+    else run<Allocator<std::pair<const int, int>>>("mixed ");
+    return 0;
+}
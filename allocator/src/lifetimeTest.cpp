@@ -0,0 +1,68 @@
+#include "mem_Allocator.hpp"
+#include "Test.hpp"
+#include <bits/stdc++.h>
+
+using LongMap = std::map<int, int, std::less<int>, LongLivedAllocator<std::pair<const int, int>>>;
+using ShortVec = std::vector<int, Allocator<int>>;
+
+// lifetime of the buffer pointer lives in
+MemoryPool::Lifetime lifetimeOf(const void* pointer) {
+    for (const MemoryPool::BufferInfo& info : MemoryPool::instance().buffer_report()) {
+        if (info.start <= pointer && pointer < (const char*)info.start + MemoryPool::buffer_size) return info.lifetime;
+    }
+    assert(false && "Pointer is not in any buffer.");
+    return MemoryPool::Lifetime::Short;
+}
+
+// long-lived map nodes interleaved with short-lived vectors never share a buffer,
+// so freeing the vectors reclaims every short-lived buffer
+void lifetimeTest() {
+    std::cout << "Running lifetime segregation test" << std::endl;
+    MemoryPool& pool = MemoryPool::instance();
+    pool.release_empty();
+    size_t reclaimed_before = pool.stats().buffers_reclaimed;
+
+    LongMap kept;
+    {
+        std::vector<ShortVec> temporary;
+        for (int i = 0; i < OPERATIONS / 50; i++) {
+            temporary.emplace_back(rng() % 500 + 1, i);
+            kept.emplace(generateValue<int>(), i);
+        }
+        for (auto& kv : kept) {
+            assert(lifetimeOf(&kv) == MemoryPool::Lifetime::Long && "Long-lived node in a short-lived buffer.");
+        }
+        for (auto& v : temporary) {
+            assert(lifetimeOf(v.data()) == MemoryPool::Lifetime::Short && "Short-lived vector in a long-lived buffer.");
+        }
+        size_t short_buffers = 0;
+        for (const MemoryPool::BufferInfo& info : pool.buffer_report()) {
+            if (info.lifetime == MemoryPool::Lifetime::Short) short_buffers++;
+        }
+        std::cerr << "short-lived buffers: " << short_buffers << std::endl;
+        assert(short_buffers > 1);
+    }
+    // the temporary vectors (and the storage of `temporary` itself) are gone, the map is not
+
+    size_t reclaimed = pool.stats().buffers_reclaimed - reclaimed_before;
+    std::cerr << "reclaimed: " << reclaimed << std::endl;
+    for (const MemoryPool::BufferInfo& info : pool.buffer_report()) {
+        if (info.lifetime == MemoryPool::Lifetime::Short) {
+            assert(info.count == 0 && "A short-lived buffer is still pinned.");
+        }
+    }
+    assert(reclaimed > 0);
+    size_t released = pool.release_empty();
+    for (const MemoryPool::BufferInfo& info : pool.buffer_report()) {
+        assert(info.lifetime == MemoryPool::Lifetime::Long && info.count > 0);
+    }
+    std::cerr << "released " << released << " buffers, " << kept.size() << " nodes kept" << std::endl;
+    std::cout << "Lifetime segregation test passed." << std::endl;
+}
+
+int main() {
+    std::cout << "Running lifetime tests..." << std::endl;
+    lifetimeTest();
+    std::cout << "All lifetime tests passed.\n" << std::endl;
+    return 0;
+}
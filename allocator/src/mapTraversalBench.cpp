@@ -0,0 +1,77 @@
+#include "Allocator.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <random>
+#include <vector>
+
+// In-order traversal of a std::map whose nodes were inserted either plainly or
+// with emplace_near. A second map shares the pool (same node size) to interleave
+// allocations. Both maps then repeatedly shrink by a quarter and grow back with
+// new random keys, which leaves free slots all over the pool as in a long-running
+// process. Usage: mapTraversalBench [plain|near]
+
+using Map = std::map<int, int, std::less<int>, Allocator<std::pair<const int, int>>>;
+
+const int MapSize = 1 << 19;
+const int ChurnRounds = 8;
+const int Traversals = 20;
+
+std::mt19937 rng(67656);
+bool use_hint = false;
+
+void insert(Map& m, int key) {
+    if (use_hint) emplace_near(m, m.lower_bound(key), key, key);
+    else m.emplace(key, key);
+}
+
+void eraseRandom(Map& m) {
+    auto it = m.lower_bound(static_cast<int>(rng()));
+    if (it == m.end()) it = m.begin();
+    m.erase(it);
+}
+
+int main(int argc, char** argv) {
+    use_hint = argc > 1 && std::strcmp(argv[1], "near") == 0;
+    Map map, noise;
+    while ((int)map.size() < MapSize) {
+        insert(map, static_cast<int>(rng()));
+        insert(noise, static_cast<int>(rng()));
+    }
+    for (int i = 0; i < ChurnRounds; i++) {
+        for (int j = 0; j < MapSize / 4; j++) {
+            eraseRandom(map);
+            eraseRandom(noise);
+        }
+        while ((int)map.size() < MapSize) {
+            insert(map, static_cast<int>(rng()));
+            insert(noise, static_cast<int>(rng()));
+        }
+    }
+
+    // share of in-order neighbours that live in the same 4 KiB page
+    size_t same_page = 0;
+    const void* last = nullptr;
+    for (auto& kv : map) {
+        if (last != nullptr && ((size_t)last >> 12) == ((size_t)&kv >> 12)) same_page++;
+        last = &kv;
+    }
+
+    // median over the traversals, single passes are noisy on a shared machine
+    long long sum = 0;
+    std::vector<double> ns(Traversals);
+    for (int t = 0; t < Traversals; t++) {
+        auto start = std::chrono::steady_clock::now();
+        for (auto& kv : map) sum += kv.second;
+        auto end = std::chrono::steady_clock::now();
+        ns[t] = std::chrono::duration<double, std::nano>(end - start).count() / map.size();
+    }
+    std::sort(ns.begin(), ns.end());
+
+    std::cout << (use_hint ? "near " : "plain") << ": " << map.size() << " nodes, "
+        << 100.0 * same_page / (map.size() - 1) << "% neighbours in the same page, median "
+        << ns[Traversals / 2] << " ns per node (checksum " << sum << ")" << std::endl;
+    return 0;
+}
@@ -0,0 +1,66 @@
+#include "Allocator.hpp"
+#include "Test.hpp"
+#include <bits/stdc++.h>
+
+// built with -DALLOCATOR_STATS, see the `shared` target of the Makefile
+#ifndef ALLOCATOR_STATS
+#error "sharedPoolTest needs ALLOCATOR_STATS"
+#endif
+
+using Pair = std::pair<int, long long>;
+
+// a block freed through one element type is handed out again to another type of the same size class
+void crossTypeTest() {
+    std::cout << "Running cross-type reuse test" << std::endl;
+    Allocator<int> ints;
+    Allocator<Pair> pairs;
+    static_assert(12 * sizeof(int) == 3 * sizeof(Pair), "both requests must be of the same size class");
+    for (int i = 0; i < OPERATIONS / 100; i++) {
+        int* a = ints.allocate(12);
+        ints.deallocate(a, 12);
+        Pair* b = pairs.allocate(3);
+        assert(static_cast<void*>(a) == static_cast<void*>(b) && "Block was not reused across types.");
+        pairs.deallocate(b, 3);
+        int* c = ints.allocate(12);
+        assert(static_cast<void*>(b) == static_cast<void*>(c) && "Block was not reused across types.");
+        ints.deallocate(c, 12);
+    }
+    std::cout << "Cross-type reuse test passed." << std::endl;
+}
+
+// per-type counters are kept apart even though the memory is shared
+void statsTest() {
+    std::cout << "Running stats test" << std::endl;
+    MemoryPool::Stats& int_stats = Allocator<int>::stats();
+    MemoryPool::Stats& pair_stats = Allocator<Pair>::stats();
+    MemoryPool::Stats int_before = int_stats;
+    MemoryPool::Stats pair_before = pair_stats;
+    {
+        MyVector<int, Allocator<int>> a;
+        MyVector<Pair, Allocator<Pair>> b;
+        for (int i = 0; i < OPERATIONS; i++) {
+            a.push_back(generateValue<int>());
+            if (i % 4 == 0) b.push_back(generateValue<Pair>());
+        }
+        assert(int_stats.bytes_in_use == int_before.bytes_in_use + a.capacity() * sizeof(int));
+        assert(pair_stats.bytes_in_use == pair_before.bytes_in_use + b.capacity() * sizeof(Pair));
+        assert(int_stats.peak_bytes >= int_stats.bytes_in_use);
+        assert(int_stats.allocations > int_before.allocations);
+        assert(pair_stats.allocations > pair_before.allocations);
+    }
+    assert(int_stats.bytes_in_use == int_before.bytes_in_use && "Counters do not return to their start.");
+    assert(pair_stats.bytes_in_use == pair_before.bytes_in_use && "Counters do not return to their start.");
+    assert(int_stats.allocations - int_before.allocations == int_stats.deallocations - int_before.deallocations);
+    assert(pair_stats.allocations - pair_before.allocations == pair_stats.deallocations - pair_before.deallocations);
+    std::cerr << "int: " << int_stats.allocations << " allocations, peak " << int_stats.peak_bytes << " bytes" << std::endl;
+    std::cerr << "pair: " << pair_stats.allocations << " allocations, peak " << pair_stats.peak_bytes << " bytes" << std::endl;
+    std::cout << "Stats test passed." << std::endl;
+}
+
+int main() {
+    std::cout << "Running shared pool tests..." << std::endl;
+    crossTypeTest();
+    statsTest();
+    std::cout << "All shared pool tests passed.\n" << std::endl;
+    return 0;
+}
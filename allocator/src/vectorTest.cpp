@@ -1,7 +1,11 @@
 #include <iostream>
 #include <random>
 #include <vector>
+#ifdef USE_MEM_ALLOCATOR
+#include "mem_Allocator.hpp"
+#else
 #include "Allocator.hpp"
+#endif
 
 // include header of your allocator here
 // template<class T> using MyAllocator = std::allocator<T>; // replace the std::allocator with your allocator
@@ -0,0 +1,103 @@
+#include "mem_Allocator.hpp"
+#include "Test.hpp"
+#include <bits/stdc++.h>
+
+bool isZero(const void* pointer, size_t size) {
+    const char* p = static_cast<const char*>(pointer);
+    return std::all_of(p, p + size, [](char c) { return c == 0; });
+}
+
+// cmalloc must return zero memory whether it is fresh, reused after free or purged,
+// and for sizes above buffer_size, which get a Block of their own that may reuse a freed node
+void cmallocTest() {
+    std::cout << "Running cmalloc test" << std::endl;
+    MemoryPool pool;
+    for (int i = 0; i < OPERATIONS / 100; i++) {
+        size_t size = rng() % MemoryPool::buffer_size + 1;
+        if (rng() % 8 == 0) size += MemoryPool::buffer_size;
+        void* p = pool.cmalloc(size);
+        assert(isZero(p, size) && "cmalloc returned dirty memory.");
+        memset(p, 0xff, size);
+        if (rng() % 4) pool.free(p, size);
+        if (rng() % 16 == 0) {
+            std::cerr << "purge " << pool.purge() << " bytes" << std::endl;
+        }
+        size_t small = rng() % 64 + 1;
+        void* q = pool.malloc(small);
+        memset(q, 0xff, small);
+        pool.free(q, small);
+    }
+    std::cout << "cmalloc test passed." << std::endl;
+}
+
+// ZeroVector leaves slots it gave up dirty, so growing back into them has to clear them
+void zeroVectorTest() {
+    std::cout << "Running ZeroVector test of int" << std::endl;
+    ZeroVector<int> a;
+    std::vector<int> b;
+    for (int i = 0; i < OPERATIONS; i++) {
+        int op = rng() % 5;
+        switch (op) {
+        case 0:
+        {// clear, or copy and shrink to fit, both of which leave the grown part zero again
+            if (rng() % 16 == 0) { // to have less clear
+                if (rng() % 2) {
+                    a.clear();
+                    b.clear();
+                    std::cerr << "clear vector" << std::endl;
+                } else {
+                    ZeroVector<int> copy(a);
+                    copy.shrink_to_fit();
+                    a = std::move(copy);
+                    std::cerr << "copy vector" << std::endl;
+                }
+                break;
+            }
+        }
+        case 1:
+        {// erase
+            if (!a.empty()) {
+                size_t pos = rng() % a.size();
+                a.erase(a.begin() + pos);
+                b.erase(b.begin() + pos);
+            }
+        }
+        case 2:
+        {// resize
+            size_t new_size = rng() % 1000;
+            a.resize(new_size);
+            b.resize(new_size);
+            std::cerr << "resize to " << new_size << std::endl;
+            break;
+        }
+        case 3:
+        {// pop_back
+            if (!a.empty()) {
+                a.pop_back();
+                b.pop_back();
+                std::cerr << "pop back" << std::endl;
+                break;
+            }
+        }
+        case 4:
+        {// push_back
+            int val = generateValue<int>();
+            a.push_back(val);
+            b.push_back(val);
+            break;
+        }
+        default:
+            break;
+        }
+        compare(a, b);
+    }
+    std::cout << "ZeroVector test passed." << std::endl;
+}
+
+int main() {
+    std::cout << "Running zero tests..." << std::endl;
+    cmallocTest();
+    zeroVectorTest();
+    std::cout << "All zero tests passed.\n" << std::endl;
+    return 0;
+}